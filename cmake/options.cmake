@@ -14,6 +14,8 @@ option(BUILD_RTLIB "Building runtime library (can be disabled safely for compone
 option(BUILD_DOCS "Build manuals from LaTeX sources" ON)
 option(USE_COTIRE "Enable Cotire precompiled headers")
 option(USE_GNU_DEMANGLER "Use cxa_demangle (ON) or binutils demangle (OFF)" ON)
+option(BUILD_BENCHMARKS "Build the performance benchmarks in examples" OFF)
+option(BUILD_TESTS "Build the component checks in tests and register them with CTest" OFF)
 
 option (ENABLE_LTO "Enable Link-Time Optimization" OFF)
 
@@ -968,6 +968,32 @@ ia32_decode_opcode(unsigned int capa, const unsigned char *addr, ia32_instructio
 COMMON_EXPORT ia32_instruction &
 ia32_decode(unsigned int capabilities, const unsigned char *addr, ia32_instruction &, bool mode_64);
 
+/**
+ * Result of the fast-path decoder: the table entry ia32_decode would
+ * select, the instruction length, the ModRM reg field (needed to name
+ * Grp2/Grp11 instructions; -1 without a ModRM byte) and the position and
+ * size of a trailing relative branch displacement (-1 and 0 if none).
+ */
+struct ia32_fast_insn {
+  ia32_entry *entry;
+  unsigned int size;
+  int modrm_reg;
+  int rel_pos;
+  int rel_size;
+};
+
+/**
+ * Table-driven decoding of length and opcode for the common 64-bit
+ * encodings: one-byte and 0F opcodes with at most an operand-size and a
+ * REX prefix. Reads no more than avail bytes from addr. Returns false,
+ * without consuming anything, for encodings it does not cover or that do
+ * not fit in avail bytes; ia32_decode handles those. Operands are not
+ * decoded.
+ */
+COMMON_EXPORT bool
+ia32_decode_fast(const unsigned char *addr, size_t avail, bool mode_64,
+                 ia32_fast_insn &insn);
+
 
 enum dynamic_call_address_mode {
   REGISTER_DIRECT, REGISTER_INDIRECT,
@@ -73,6 +73,22 @@ namespace Dyninst
       /// the size of the instruction decoded.
       Instruction decode(const unsigned char *buffer);
       void doDelayedDecode(const Instruction* insn_to_complete);
+      /// A compact summary of one decoded instruction, as produced by \c decodeRange.
+      struct INSTRUCTION_EXPORT record
+      {
+          unsigned int offset;      ///< Offset from the position at which \c decodeRange started
+          unsigned char length;     ///< Size of the instruction in bytes
+          unsigned char category;   ///< The instruction's \c InsnCategory
+          bool hasTarget;           ///< True if \c target holds a direct branch or call target
+          Address target;
+      };
+      /// Decode instructions sequentially from the current position in this %InstructionDecoder object's
+      /// buffer into \c out, stopping at the end of the buffer, at the first invalid instruction,
+      /// or after \c max records.  \c base is the address of the current position and is used to
+      /// resolve branch targets.  The buffer is left positioned after the last instruction recorded,
+      /// so a caller that sees fewer than \c max records before the end of the buffer can skip
+      /// the invalid bytes and resume.  Returns the number of records written.
+      size_t decodeRange(Address base, record* out, size_t max);
       struct INSTRUCTION_EXPORT buffer
       {
           const unsigned char* start;
@@ -36,11 +36,9 @@
 #include "entryIDs.h"
 #include "Result.h"
 #include <set>
-#include <mutex>
 
 #include "util.h"
-#include <boost/thread/lockable_adapter.hpp>
-#include <boost/thread/recursive_mutex.hpp>
+#include <boost/atomic.hpp>
 #include <boost/flyweight.hpp>
 
 // OpCode = operation + encoding
@@ -94,11 +92,23 @@ namespace Dyninst
     /// %Operations are constructed by the %InstructionDecoder as part of the process
     /// of constructing an %Instruction.
     
-    class Operation_impl : public boost::lockable_adapter<boost::recursive_mutex>
+    class Operation_impl
     {
     public:
       typedef std::set<RegisterAST::Ptr> registerSet;
       typedef std::set<Expression::Ptr> VCSet;
+      /// Implicit register and memory effects, built on first use.  They depend only on
+      /// the operation ID, prefixes, address width and architecture, so the register IDs
+      /// behind them are computed once per combination (NonOperandSpec), but each
+      /// %Operation builds its own expressions from those.
+      struct NonOperandSpec;
+      struct NonOperandData
+      {
+        registerSet otherRead;
+        registerSet otherWritten;
+        VCSet otherEffAddrsRead;
+        VCSet otherEffAddrsWritten;
+      };
       friend class InstructionDecoder_power; // for editing mnemonics after creation
       friend class InstructionDecoder_aarch64;
       
@@ -108,6 +118,7 @@ namespace Dyninst
       INSTRUCTION_EXPORT Operation_impl(const Operation_impl& o);
       INSTRUCTION_EXPORT Operation_impl();
       INSTRUCTION_EXPORT Operation_impl(entryID id, std::string m, Architecture arch);
+      INSTRUCTION_EXPORT ~Operation_impl();
       
       INSTRUCTION_EXPORT const Operation_impl& operator=(const Operation_impl& o);
       
@@ -151,13 +162,11 @@ namespace Dyninst
       bool isVectorInsn;
 
     private:
-        std::once_flag data_initialized;
-      void SetUpNonOperandData(bool doFlags = false) ;
-      
-      mutable registerSet otherRead;
-      mutable registerSet otherWritten;
-      mutable VCSet otherEffAddrsRead;
-      mutable VCSet otherEffAddrsWritten;
+      const NonOperandData& SetUpNonOperandData(bool doFlags = false) ;
+      const NonOperandSpec& getNonOperandSpec();
+
+      mutable boost::atomic<const NonOperandData*> nonOperandData;
+      mutable boost::atomic<const NonOperandSpec*> nonOperandSpec;
 
     protected:
         mutable entryID operationID;
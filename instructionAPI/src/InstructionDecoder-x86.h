@@ -73,6 +73,8 @@ namespace Dyninst
       
                 INSTRUCTION_EXPORT virtual void setMode(bool is64);
                 virtual void doDelayedDecode(const Instruction* insn_to_complete);
+                virtual size_t decodeRange(InstructionDecoder::buffer& b, Address base,
+                                           InstructionDecoder::record* out, size_t max);
 
             protected:
       
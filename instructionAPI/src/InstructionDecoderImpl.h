@@ -51,6 +51,8 @@ class InstructionDecoderImpl
         virtual ~InstructionDecoderImpl() {}
         virtual Instruction decode(InstructionDecoder::buffer& b);
         virtual void doDelayedDecode(const Instruction* insn_to_complete) = 0;
+        virtual size_t decodeRange(InstructionDecoder::buffer& b, Address base,
+                                   InstructionDecoder::record* out, size_t max);
         virtual void setMode(bool is64) = 0;
         static Ptr makeDecoderImpl(Architecture a);
 
@@ -59,6 +61,7 @@ class InstructionDecoderImpl
         virtual bool decodeOperands(const Instruction* insn_to_complete) = 0;
 
         virtual void decodeOpcode(InstructionDecoder::buffer&) = 0;
+        bool decodeRecord(InstructionDecoder::buffer& b, Address addr, InstructionDecoder::record& r);
       
         virtual Expression::Ptr makeAddExpression(Expression::Ptr lhs, Expression::Ptr rhs, Result_Type resultType);
         virtual Expression::Ptr makeMultiplyExpression(Expression::Ptr lhs, Expression::Ptr rhs, Result_Type resultType);
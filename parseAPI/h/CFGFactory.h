@@ -32,6 +32,9 @@
 
 #include "dyntypes.h"
 
+#include <map>
+#include <boost/thread/mutex.hpp>
+
 #include "LockFreeQueue.h"
 #include "CFG.h"
 #include "InstructionSource.h"
@@ -89,6 +92,10 @@ public:
   void add(elem new_elem) {
     queue.insert(new_elem);
   }
+
+  void clear() {
+    queue.clear();
+  }
     
   // iterators
   iterator begin() { return queue.begin(); }
@@ -159,6 +166,47 @@ class PARSER_EXPORT CFGFactory : public boost::basic_lockable_adapter<boost::rec
     fact_list<Function *> funcs_;
 };
 
+/** A CFGFactory that places Blocks and Edges in large contiguous slabs
+    rather than allocating each one separately, which removes per-object
+    allocator overhead and keeps blocks that were created together close
+    in memory. Each parsing thread carves objects from a slab of its own,
+    so only taking a fresh slab is serialized. The objects are ordinary
+    Blocks and Edges; destroying one runs its destructor, and the slabs
+    are released with the factory. **/
+class PARSER_EXPORT ArenaCFGFactory : public CFGFactory {
+ public:
+    ArenaCFGFactory(size_t slab_size = 1 << 20);
+    virtual ~ArenaCFGFactory();
+
+    // bytes of slab memory allocated and handed out; bytes_used is
+    // exact only while no thread is allocating
+    size_t bytes_reserved() const;
+    size_t bytes_used() const;
+
+ protected:
+    virtual Block * mkblock(Function * f, CodeRegion * r,
+            Address addr);
+    virtual Edge * mkedge(Block * src, Block * trg,
+            EdgeTypeEnum type);
+    virtual Block * mksink(CodeObject *obj, CodeRegion *r);
+
+    virtual void free_block(Block * b);
+    virtual void free_edge(Edge * e);
+
+ private:
+    struct slab_cursors;
+
+    void * allocate(size_t size);
+    char * new_slab(size_t size);
+    bool owns(void * p) const;
+
+    mutable boost::mutex arena_lock_;
+    std::map<char *, size_t> slabs_;
+    slab_cursors * cursors_;
+    size_t slab_size_;
+    size_t reserved_;
+};
+
 
 
     }
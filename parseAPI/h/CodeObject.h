@@ -40,6 +40,7 @@
 #include "CFGFactory.h"
 #include "CFG.h"
 #include "ParseContainers.h"
+#include "DecodeCache.h"
 
 namespace Dyninst {
 namespace ParseAPI {
@@ -97,6 +98,16 @@ class CodeObject {
     // `speculative' parsing
     PARSER_EXPORT void parseGaps(CodeRegion *cr, GapParsingType type=IdiomMatching);
 
+    // incremental re-parsing of code that changed after it was parsed.
+    // Re-parses and re-finalizes only the functions overlapping the
+    // [start,end) ranges in `dirty' (plus callers whose view of a
+    // callee's return status changed); `changed' receives every
+    // Function whose blocks, edges or return status may differ,
+    // including functions newly discovered by the re-parse.
+    PARSER_EXPORT bool reparse(CodeRegion *cr,
+            std::vector<std::pair<Address, Address> > const& dirty,
+            std::set<Function*> & changed);
+
     /** Lookup routines **/
 
     // functions
@@ -129,6 +140,10 @@ class CodeObject {
     PARSER_EXPORT CFGFactory * fact() const { return _fact; }
     PARSER_EXPORT bool defensiveMode() { return defensive; }
 
+    // Decoded instructions shared by the parser and later analyses;
+    // sized by DYNINST_DECODE_CACHE_MB and disabled in defensive mode
+    PARSER_EXPORT DecodeCache & decodeCache() { return *_icache; }
+
     PARSER_EXPORT bool isIATcall(Address insn, std::string &calleeName);
 
     // This is for callbacks; it is often much more efficient to 
@@ -161,8 +176,21 @@ class CodeObject {
     PARSER_EXPORT Address getFreeAddr() const;
     ParseData* parse_data();
 
+    /*
+     * Persistent CFG cache. saveCache() writes the finalized CFG to
+     * a versioned cache file keyed by the CodeSource's cacheKey().
+     * If DYNINST_PARSE_CACHE_DIR is set, CodeObjects load a matching
+     * cache from that directory instead of parsing, and populate it
+     * after parsing when no usable cache exists.  A loaded CFG
+     * replays the interproc_cf and newfunction_retstatus callbacks of
+     * the parse it was saved from; no other parsing callback is made.
+     */
+    PARSER_EXPORT bool saveCache(std::string const& path);
+    PARSER_EXPORT bool loadedFromCache() const { return from_cache; }
+
  private:
     void process_hints();
+    std::string cache_path() const;
     void add_edge(Block *src, Block *trg, EdgeTypeEnum et);
     // allows Functions to link up return edges after-the-fact
     friend void Function::delayed_link_return(CodeObject *,Block*);
@@ -175,11 +203,13 @@ class CodeObject {
     CodeSource * _cs;
     CFGFactory * _fact;
     ParseCallbackManager * _pcb;
+    DecodeCache * _icache;
 
     Parser * parser; // parser implementation
 
     bool owns_factory;
     bool defensive;
+    bool from_cache;
     funclist& flist;
 };
 
@@ -193,6 +193,15 @@ class PARSER_EXPORT CodeSource : public Dyninst::InstructionSource {
      */
     virtual Address getTOC(Address) const { return _table_of_contents; }
 
+    /* Returns a string that uniquely identifies the code provided by
+       this source (e.g. the ELF build-id), used to key persistent
+       parse caches. Sources that cannot identify their contents
+       return false and are never cached.
+
+       Optional.
+    */
+    virtual bool cacheKey(std::string & /*key*/) const { return false; }
+
     // statistics accessor
     virtual void print_stats() const { return; }
     virtual bool have_stats() const { return false; }
@@ -296,6 +305,7 @@ class PARSER_EXPORT SymtabCodeSource : public CodeSource, public boost::lockable
     Address baseAddress() const;
     Address loadAddress() const;
     Address getTOC(Address addr) const;
+    bool cacheKey(std::string & key) const;
     SymtabAPI::Symtab * getSymtabObject() {return _symtab;} 
 
     /** InstructionSource implementation **/
@@ -331,6 +341,7 @@ class PARSER_EXPORT SymtabCodeSource : public CodeSource, public boost::lockable
     void init_hints(RegionMap &, hint_filt*);
     void init_linkage();
     void init_try_blocks();
+    bool buildId(std::string & id) const;
 
     CodeRegion * lookup_region(const Address addr) const;
     void removeRegion(CodeRegion &); // removes from region tree
@@ -0,0 +1,121 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#ifndef _COMPACT_CFG_H_
+#define _COMPACT_CFG_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "dyntypes.h"
+#include "CFG.h"
+
+namespace Dyninst {
+namespace ParseAPI {
+
+class CodeObject;
+
+/*
+ * A read-only, compact snapshot of a finalized CodeObject's CFG for
+ * whole-binary traversals. Blocks are numbered 0..num_blocks()-1 in
+ * address order and stored as contiguous records; edges are kept in
+ * CSR form (an offset array per block into one edge array) with 32-bit
+ * block indices in place of pointers. Every index maps back to the
+ * underlying Block, so results can be reported through the ordinary
+ * Block/Edge/Function interfaces.
+ *
+ * The snapshot does not track later changes to the CodeObject.
+ */
+class PARSER_EXPORT CompactCFG {
+ public:
+    typedef uint32_t index_t;
+    static const index_t none = 0xffffffff;
+
+    enum {
+        INTERPROC = 0x1,  // Edge::interproc()
+        SINK = 0x2        // target is the sink or outside the snapshot
+    };
+
+    struct edge {
+        index_t block;    // target for out-edges, source for in-edges
+        uint8_t type;     // EdgeTypeEnum
+        uint8_t flags;
+    };
+
+    explicit CompactCFG(CodeObject * co);
+
+    size_t num_blocks() const { return _blocks.size(); }
+    size_t num_edges() const { return _out.size(); }
+    size_t num_funcs() const { return _funcs.size(); }
+
+    Block * block(index_t b) const { return _blocks[b]; }
+    Address start(index_t b) const { return _recs[b].start; }
+    Address end(index_t b) const { return _recs[b].start + _recs[b].size; }
+    // none if b is not in the snapshot
+    index_t index(Block * b) const;
+
+    const edge * out_begin(index_t b) const { return _out.data() + _out_off[b]; }
+    const edge * out_end(index_t b) const { return _out.data() + _out_off[b+1]; }
+    const edge * in_begin(index_t b) const { return _in.data() + _in_off[b]; }
+    const edge * in_end(index_t b) const { return _in.data() + _in_off[b+1]; }
+
+    Function * func(index_t f) const { return _funcs[f]; }
+    index_t func_entry(index_t f) const { return _func_entry[f]; }
+    const index_t * func_blocks_begin(index_t f) const { return _func_blocks.data() + _func_off[f]; }
+    const index_t * func_blocks_end(index_t f) const { return _func_blocks.data() + _func_off[f+1]; }
+
+    // bytes held by the snapshot's arrays
+    size_t memory_bytes() const;
+
+ private:
+    struct block_rec {
+        Address start;
+        uint32_t size;
+        uint32_t region;
+    };
+
+    std::vector<block_rec> _recs;
+    std::vector<Block *> _blocks;
+    std::vector<CodeRegion *> _regions;
+
+    std::vector<uint32_t> _out_off;
+    std::vector<edge> _out;
+    std::vector<uint32_t> _in_off;
+    std::vector<edge> _in;
+
+    std::vector<Function *> _funcs;
+    std::vector<index_t> _func_entry;
+    std::vector<uint32_t> _func_off;
+    std::vector<index_t> _func_blocks;
+};
+
+}
+}
+
+#endif
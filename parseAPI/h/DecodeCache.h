@@ -0,0 +1,148 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#ifndef _DECODE_CACHE_H_
+#define _DECODE_CACHE_H_
+
+#include <stdio.h>
+#include <deque>
+#include <utility>
+#include <unordered_map>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "dyntypes.h"
+#include "Instruction.h"
+
+namespace Dyninst {
+namespace ParseAPI {
+
+class CodeRegion;
+
+/*
+ * A bounded, thread-safe cache of decoded instructions, keyed by
+ * (CodeRegion, address). Each CodeObject owns one; the parser fills
+ * it as it walks blocks, and later consumers (Block::getInsns,
+ * liveness, slicing, stack analysis) look instructions up in it
+ * instead of fetching and decoding the same bytes again.
+ *
+ * Only the opcode and length are shared. Instructions are handed out
+ * by value, as decoded as the parser leaves them, without operands:
+ * operand expressions are mutable (bind(), setValue()) and cannot be
+ * copied deeply, so each copy decodes its own on first use. A full
+ * liveness plus stack analysis run therefore still decodes the operands
+ * of an instruction once per consumer, not once in all.
+ *
+ * The cache is split into shards, each with its own lock and a share
+ * of the memory cap; a shard that grows past its share evicts entries
+ * in CLOCK (second chance) order. Memory use is an estimate.
+ */
+class PARSER_EXPORT DecodeCache {
+ public:
+    // Capacity in bytes; 0 disables caching
+    explicit DecodeCache(size_t capacity);
+    ~DecodeCache();
+
+    // Capacity taken from DYNINST_DECODE_CACHE_MB, if set
+    static size_t default_capacity();
+
+    bool enabled() const { return _capacity != 0; }
+    size_t capacity() const { return _capacity; }
+
+    // Returns the instruction at `addr', decoding and caching it on a
+    // miss. Returns an invalid Instruction if `addr' is not in `cr'.
+    InstructionAPI::Instruction decode(CodeRegion * cr, Address addr);
+
+    // Copies the cached instruction at `addr' into `insn', if any
+    bool lookup(CodeRegion * cr, Address addr,
+                InstructionAPI::Instruction & insn);
+
+    // Publishes an instruction that was decoded elsewhere (e.g., by the
+    // parser), before its operands have been decoded
+    void insert(CodeRegion * cr, Address addr,
+                InstructionAPI::Instruction const& insn);
+
+    // Drops cached instructions in `cr' that overlap [start,end)
+    void invalidate(CodeRegion * cr, Address start, Address end);
+    void clear();
+
+    unsigned long hits() const { return _hits.load(); }
+    unsigned long misses() const { return _misses.load(); }
+    unsigned long evictions() const { return _evictions.load(); }
+    size_t size() const;
+    size_t bytes() const;
+
+    void print_stats(FILE * out) const;
+
+ private:
+    typedef std::pair<CodeRegion *, Address> key_t;
+
+    struct key_hash {
+        size_t operator()(key_t const& k) const {
+            return (size_t) k.second * 31 + ((size_t) k.first >> 4);
+        }
+    };
+
+    struct entry {
+        InstructionAPI::Instruction insn;
+        unsigned bytes;
+        bool referenced;    // CLOCK reference bit
+    };
+
+    struct Shard {
+        Shard() : bytes(0) { }
+        mutable boost::mutex lock;
+        std::unordered_map<key_t, entry, key_hash> entries;
+        std::deque<key_t> clock;
+        size_t bytes;
+    };
+
+    static const unsigned num_shards = 64;
+
+    Shard & shard(Address addr) {
+        // adjacent instructions land in different shards
+        return _shards[(addr ^ (addr >> 6)) % num_shards];
+    }
+    void evict(Shard & s);
+    static unsigned estimate(InstructionAPI::Instruction const& insn);
+
+    size_t _capacity;
+    size_t _shard_capacity;
+    Shard _shards[num_shards];
+
+    boost::atomic<unsigned long> _hits;
+    boost::atomic<unsigned long> _misses;
+    boost::atomic<unsigned long> _evictions;
+};
+
+}
+}
+
+#endif
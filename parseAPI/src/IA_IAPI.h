@@ -166,6 +166,8 @@ protected:
         static std::map<Architecture, Dyninst::InstructionAPI::RegisterAST::Ptr> thePC;
         static std::map<Address, bool> thunkAtTarget;
         static void initASTs();
+        // Shares the current instruction with the CodeObject's decode cache
+        void publishCurInsn() const;
 };
 
 }
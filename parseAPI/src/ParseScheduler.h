@@ -0,0 +1,118 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#ifndef _PARSE_SCHEDULER_H_
+#define _PARSE_SCHEDULER_H_
+
+#include <stdio.h>
+#include <deque>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "LockFreeQueue.h"
+
+namespace Dyninst {
+namespace ParseAPI {
+
+class CodeRegion;
+class ParseFrame;
+
+/*
+ * Work-stealing scheduler for parse frames, an alternative to the
+ * OpenMP task-based scheduling in Parser::ProcessFrames.
+ *
+ * Each worker owns a deque of frames; it pushes and pops at the back
+ * and idle workers steal from the front of a victim's deque. Frames
+ * are placed by CodeRegion: new frames stay with the worker that
+ * produced them when they belong to the same region, and otherwise go
+ * to the home worker of their region, so that one region's frames
+ * (and the instruction bytes and lookup structures they touch) tend
+ * to stay on one thread.
+ */
+class ParseScheduler {
+ public:
+    enum Kind {
+        OpenMP,
+        WorkStealing
+    };
+
+    // Selected by DYNINST_PARSE_SCHEDULER ("openmp" or "worksteal")
+    static Kind configured();
+
+    // Processes one frame and returns any frames it made runnable
+    typedef boost::function<LockFreeQueueItem<ParseFrame *> *(ParseFrame *)> process_t;
+
+    struct Stats {
+        Stats() : frames(0), resumes(0), steals(0), failed_steals(0),
+                  idle_ns(0) { }
+        unsigned long frames;         // frames processed
+        unsigned long resumes;        // frames processed after a prior suspension
+        unsigned long steals;         // frames taken from another worker
+        unsigned long failed_steals;  // steal attempts that found nothing
+        unsigned long long idle_ns;   // time spent with no local work
+
+        Stats & operator+=(const Stats & o);
+    };
+
+    explicit ParseScheduler(unsigned nworkers);
+    ~ParseScheduler();
+
+    // Runs all frames in `work' and everything they spawn to completion
+    void run(LockFreeQueueItem<ParseFrame *> * work, process_t process);
+
+    // Accumulated over every run() of this scheduler
+    const Stats & totals() const { return _totals; }
+    void print_stats(FILE * out) const;
+
+ private:
+    struct Worker {
+        boost::mutex lock;
+        std::deque<ParseFrame *> frames;
+        Stats stats;
+    };
+
+    void worker_loop(unsigned id);
+    void push(unsigned id, ParseFrame * pf);
+    bool pop(unsigned id, ParseFrame *& pf);
+    bool steal(unsigned id, ParseFrame *& pf);
+    unsigned home(CodeRegion * cr) const;
+
+    std::vector<Worker *> _workers;
+    process_t _process;
+    boost::atomic<long> _pending;
+    Stats _totals;
+};
+
+}
+}
+
+#endif
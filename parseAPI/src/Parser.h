@@ -48,10 +48,12 @@
 #include "ParseCallback.h"
 
 #include "ParseData.h"
+#include "ParseScheduler.h"
 #include "common/src/dthread.h"
 #include <boost/thread/lockable_adapter.hpp>
 #include <boost/thread/shared_mutex.hpp>
 #include <unordered_map>
+#include "tbb/concurrent_vector.h"
 
 using namespace std;
 
@@ -104,6 +106,9 @@ namespace Dyninst {
 
     // a sink block for unbound edges
     boost::atomic<Block *> _sink;
+
+    // work-stealing frame scheduler; NULL when using OpenMP tasks
+    ParseScheduler *_scheduler;
 #ifdef ADD_PARSE_FRAME_TIMERS
     tbb::concurrent_hash_map<unsigned int, unsigned int > time_histogram;
 #endif
@@ -115,6 +120,17 @@ namespace Dyninst {
         UNPARSEABLE     // error condition
     };
     ParseState _parse_state;
+
+    // interproc_cf notifications made while parsing, which a cache
+    // written from this parse replays when it is loaded
+    struct interproc_event {
+        CodeRegion *region;
+        Address func;
+        Address addr;
+        ParseCallback::interproc_details det;
+    };
+    tbb::concurrent_vector<interproc_event> interproc_events;
+    bool _record_interproc;
         public:
             Parser(CodeObject &obj, CFGFactory &fact, ParseCallbackManager &pcb);
 
@@ -173,11 +189,30 @@ namespace Dyninst {
 
             ParseData *parse_data() { return _parse_data; }
 
+            /** persistent CFG cache (Parser-cache.C) **/
+            bool write_cache(std::string const& path);
+            bool read_cache(std::string const& path);
+            // Keep the interproc_cf notifications for write_cache
+            void record_for_cache() { _record_interproc = true; }
+            void interproc_cf(Function *f, Block *b, Address addr,
+                              ParseCallback::interproc_details *det);
+
+            /** incremental re-parsing (Parser-incremental.C) **/
+            bool reparse(CodeRegion *cr,
+                         vector<pair<Address, Address> > const& dirty,
+                         set<Function *> &changed);
+
         private:
             void parse_vanilla();
             void cleanup_frames();
             void parse_gap_heuristic(CodeRegion *cr);
 
+            void reparse_funcs(set<Function *> &funcs,
+                               set<Function *> &changed,
+                               set<Function *> &callers);
+            void reset_func(Function *f);
+            void refinalize(Function *f);
+
             void probabilistic_gap_parsing(CodeRegion *cr);
             //void parse_sbp();
 
@@ -259,6 +294,7 @@ namespace Dyninst {
 
             void finalize_funcs(vector<Function *> &funcs);
 	    void clean_bogus_funcs(vector<Function*> &funcs);
+	    bool is_bogus_func(Function *f);
             void finalize_ranges(vector<Function *> &funcs);
 	    void split_overlapped_blocks();
             void split_consistent_blocks(region_data *, map<Address, Block*> &);
@@ -132,6 +132,14 @@ class PC_EXPORT Breakpoint
 
    void setSuppressCallbacks(bool);
    bool suppressCallbacks() const;
+
+   // A non-stopping breakpoint neither stops the process nor delivers
+   // callbacks; its hits are only counted (Process::drainBreakpointHits).
+   // Where the instructions at the address can be relocated it is a
+   // jump to a counting stub in the process rather than a trap.  Set
+   // before the breakpoint is added.
+   void setNonStopping(bool b);
+   bool isNonStopping() const;
 };
 
 class PC_EXPORT Library
@@ -496,6 +504,16 @@ class PC_EXPORT Process : public boost::enable_shared_from_this<Process>
    bool rmBreakpoint(Dyninst::Address addr, Breakpoint::ptr bp) const;
    unsigned numHardwareBreakpointsAvail(unsigned mode);
 
+   // Hits of non-stopping breakpoints (Breakpoint::setNonStopping), which
+   // can be collected while the process runs.  counts receives the total
+   // hits at each address since its first non-stopping breakpoint was
+   // added.  log, if given, is appended the address of each hit since the
+   // last call, oldest first; when more than 4096 hits of jump-installed
+   // breakpoints happened in between, only the latest 4096 of those are
+   // logged.
+   bool drainBreakpointHits(std::map<Dyninst::Address, unsigned long> &counts,
+                            std::vector<Dyninst::Address> *log = NULL) const;
+
    /**
     * Post IRPC.  Use continueProc/continueThread to run it,
     * and handleEvents to wait for a blocking IRPC to complete
@@ -38,6 +38,7 @@
 
 #include "response.h"
 #include "memcache.h"
+#include "nonstop_bp.h"
 
 #include "common/h/dyn_regs.h"
 #include "common/h/SymReader.h"
@@ -129,6 +130,7 @@ class mem_state
    std::set<int_library *> libs;
    std::map<Dyninst::Address, sw_breakpoint *> breakpoints;
    std::map<Dyninst::Address, unsigned long> inf_malloced_memory;
+   nonstop_breakpoints nonstop_bps;
 };
 
 /**
@@ -450,6 +452,54 @@ class int_process
    virtual bool plat_writeMemAsync(int_thread *thr, const void *local, Dyninst::Address addr,
                                    size_t size, result_response::ptr result, bp_write_t bp_write);
 
+   //ProcessSet and ThreadSet hand a whole group's memory reads, or a whole
+   // group's register reads, to these before issuing them one at a time.
+   // A platform that can serve many in a few system calls overrides them
+   // and marks the entries it completed; the rest take the usual path.
+   // By default nothing is completed.
+   struct mem_batch_t {
+      Dyninst::Address remote;
+      void *local;
+      size_t size;
+      bool done;
+   };
+   virtual void plat_readMemBatch(int_thread *thr, std::vector<mem_batch_t> &reads);
+
+   //Register reads are split in two so that every process in a set can
+   // start its reads before any is waited on.  pool is allocated by the
+   // caller, plat_data belongs to the platform between start and finish.
+   struct reg_batch_t {
+      int_thread *thr;
+      int_registerPool *pool;
+      bool done;
+      void *plat_data;
+   };
+   virtual void plat_startRegBatch(std::vector<reg_batch_t> &regs);
+   virtual void plat_finishRegBatch(std::vector<reg_batch_t> &regs);
+
+   //Read memory without stopping the process, for draining the counters
+   // of non-stopping breakpoints.  Not supported by default.
+   virtual bool plat_readMemRunning(int_thread *thr, void *local,
+                                    Dyninst::Address remote, size_t size);
+
+   //Code for a non-stopping breakpoint at addr (see nonstop_bp.h), given
+   // the original bytes there.  stub_code, to be written at stub, counts
+   // a hit of site index in the counter area, runs the instructions
+   // displaced from addr and returns after them.  jump_code replaces the
+   // displaced instructions.  Returns false if the instructions at addr
+   // cannot be displaced; by default none can.
+   virtual bool plat_createNonStopStub(Dyninst::Address addr, const unsigned char *orig,
+                                       unsigned orig_size, Dyninst::Address stub,
+                                       Dyninst::Address area, unsigned index,
+                                       std::vector<unsigned char> &stub_code,
+                                       std::vector<unsigned char> &jump_code);
+
+   //An unmapped, page-aligned address for size bytes that all lie within
+   // reach of addr, as near to addr as possible, for infMalloc to map at.
+   // Returns 0 if there is none, or the platform cannot tell.
+   virtual Dyninst::Address plat_findFreeMemoryNear(Dyninst::Address addr, unsigned long size,
+                                                    Dyninst::Address reach);
+
    bool getMemoryAccessRights(Dyninst::Address addr, Process::mem_perm& rights);
    bool setMemoryAccessRights(Dyninst::Address addr, size_t size,
                               Process::mem_perm rights,
@@ -682,6 +732,7 @@ class int_registerPool
  public:
    int_registerPool();
    int_registerPool(const int_registerPool &c);
+   int_registerPool &operator=(const int_registerPool &c);
    ~int_registerPool();
 
    typedef std::map<Dyninst::MachRegister, Dyninst::MachRegisterVal> reg_map_t;
@@ -1308,6 +1359,7 @@ class int_breakpoint
    bool procstopper;
    bool suppress_callbacks;
    bool offset_transfer;
+   bool nonstopping;
    std::set<Thread::const_ptr> thread_specific;
  public:
    int_breakpoint(Breakpoint::ptr up);
@@ -1335,6 +1387,9 @@ class int_breakpoint
    void setSuppressCallbacks(bool);
    bool suppressCallbacks(void) const;
 
+   void setNonStopping(bool b);
+   bool isNonStopping() const;
+
    bool isHW() const;
    unsigned getHWSize() const;
    unsigned getHWPerms() const;
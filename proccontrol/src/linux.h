@@ -51,9 +51,14 @@
 #include "common/src/dthread.h"
 #include <sys/types.h>
 #include <sys/ptrace.h>
+#include <deque>
+#include <map>
+#include <vector>
 
 typedef enum __ptrace_request pt_req;
 
+class LinuxPtrace;
+
 class GeneratorLinux : public GeneratorMT
 {
   private:
@@ -133,11 +138,18 @@ class linux_process : public sysv_process, public unix_process, public thread_db
                              Dyninst::Address remote, size_t size);
    virtual bool plat_writeMem(int_thread *thr, const void *local,
                               Dyninst::Address remote, size_t size, bp_write_t bp_write);
+   virtual void plat_readMemBatch(int_thread *thr, std::vector<mem_batch_t> &reads);
+   virtual bool plat_readMemRunning(int_thread *thr, void *local,
+                                    Dyninst::Address remote, size_t size);
+   virtual void plat_startRegBatch(std::vector<reg_batch_t> &regs);
+   virtual void plat_finishRegBatch(std::vector<reg_batch_t> &regs);
    virtual SymbolReaderFactory *plat_defaultSymReader();
    virtual bool needIndividualThreadAttach();
    virtual bool getThreadLWPs(std::vector<Dyninst::LWP> &lwps);
    virtual bool plat_individualRegAccess();
    virtual Dyninst::Address plat_mallocExecMemory(Dyninst::Address min, unsigned size);
+   virtual Dyninst::Address plat_findFreeMemoryNear(Dyninst::Address addr, unsigned long size,
+                                                    Dyninst::Address reach);
    virtual bool plat_getOSRunningStates(std::map<Dyninst::LWP, bool> &runningStates);
    virtual bool plat_supportLWPCreate();
    virtual bool plat_supportLWPPreDestroy();
@@ -156,8 +168,26 @@ class linux_process : public sysv_process, public unix_process, public thread_db
    virtual bool plat_getResidentUsage(unsigned long stacku, unsigned long heapu, unsigned long sharedu,
                                       MemUsageResp_t *resp);
 
+   // The tracer thread that issues this process's ptrace requests
+   LinuxPtrace *getTracer() const;
+
   protected:
    int computeAddrWidth();
+
+  private:
+   // Memory is moved with process_vm_readv/writev or /proc/pid/mem on the
+   // calling thread where possible, and by the ptracer thread otherwise
+   size_t directReadMem(int_thread *thr, void *local, Dyninst::Address remote, size_t size);
+   size_t directWriteMem(int_thread *thr, const void *local, Dyninst::Address remote,
+                         size_t size, bool text);
+   int memFD();
+   void closeMemFD();
+
+   int mem_fd;            // /proc/<pid>/mem, opened on first use
+   bool mem_fd_failed;
+   Mutex<> mem_fd_lock;
+
+   LinuxPtrace *tracer;
 };
 
 class linux_x86_process : public linux_process, public x86_process
@@ -260,9 +290,19 @@ class linux_arm_thread : virtual public linux_thread, virtual public arm_thread
    virtual ~linux_arm_thread();
 };
 
+/**
+ * Linux only accepts ptrace requests for a tracee from the thread that
+ * attached to it (or that forked it), so every ptrace call is handed to a
+ * tracer thread.  There is a pool of tracers; each process is given one
+ * when it is created or attached, keeps it for its lifetime, and passes
+ * it on to the children it forks, which the kernel attaches to the same
+ * thread.  Requests for different processes thus run in parallel on
+ * different tracers, up to DYNINST_PTRACE_THREADS tracers (by default,
+ * one per CPU).
+ **/
 class LinuxPtrace
 {
-private:
+public:
    typedef enum {
       unknown,
       create_req,
@@ -271,34 +311,67 @@ private:
       ptrace_bulkwrite
    } req_t;
 
-   req_t ptrace_request;
-   pt_req request;
-   pid_t pid;
-   void *addr;
-   void *data;
-   linux_process *proc;
-   Dyninst::Address remote_addr;
-   unsigned size;
-   long ret;
-   bool bret;
-   int err;
+   // One request, queued to and executed by a tracer thread
+   struct request_t {
+      request_t();
+
+      req_t type;
+      pt_req request;
+      pid_t pid;
+      void *addr;
+      void *data;
+      linux_process *proc;
+      Dyninst::Address remote_addr;
+      unsigned size;
+      long ret;
+      bool bret;
+      int err;
+      bool done;
+   };
 
+private:
    DThread thrd;
    CondVar<> init;
-   CondVar<> cond;
-   CondVar<> ret_lock;
-   Mutex<> request_lock;
-
-   void start_request();
-   void waitfor_ret();
-   void end_request();
-   static LinuxPtrace *linuxptrace;
+   Mutex<> queue_lock;
+   CondVar<> queue_cond;      // signaled when a request is queued
+   CondVar<> done_cond;       // broadcast when a request completes
+   std::deque<request_t *> queue;
+
+   void run(request_t *req);
+
+   struct tracee_t {
+      LinuxPtrace *tracer;
+      const void *owner;
+   };
+   static Mutex<> tracers_lock;
+   static std::vector<LinuxPtrace *> tracers;
+   static unsigned max_tracers;
+   static unsigned next_tracer;
+   static std::map<pid_t, tracee_t> tracees;
+   static LinuxPtrace *newPtracer();
 public:
+   // The first tracer
    static LinuxPtrace *getPtracer();
+   // The tracer of a registered process or thread, else the first tracer
+   static LinuxPtrace *getPtracer(pid_t pid_);
+   // A tracer for a new process: a new thread until the pool is full,
+   // then the existing ones in turn
+   static LinuxPtrace *assignPtracer();
+   // Route requests for a process or thread id to tracer.  A later
+   // registration of the same id replaces this one, and is not removed
+   // by this owner's removeTracee.
+   static void addTracee(pid_t pid_, LinuxPtrace *tracer, const void *owner);
+   static void removeTracee(pid_t pid_, const void *owner);
+
    LinuxPtrace();
    ~LinuxPtrace();
    void start();
    void main();
+
+   // Queue a request and return; wait blocks until it is complete
+   void post(request_t *req);
+   void wait(request_t *req);
+
    long ptrace_int(pt_req request_, pid_t pid_, void *addr_, void *data_);
    bool ptrace_read(Dyninst::Address inTrace, unsigned size_, void *inSelf, int pid_);
    bool ptrace_write(Dyninst::Address inTrace, unsigned size_, const void *inSelf, int pid_);
@@ -77,6 +77,14 @@ typedef enum {
  * 
  * Update - The memcache can now store registers.  Just what
  * every memcache needs.
+ *
+ * On platforms with synchronous memory access none of the above
+ * applies: operations are never restarted, and reads go through
+ * a cache of whole pages instead.  The SysV and thread_db walks
+ * issue many small reads of neighboring words, so the first read
+ * in a page fetches the page, and a read missing several adjacent
+ * pages fetches them together.  Any write through int_process
+ * drops the pages it touches, and a continue drops everything.
  **/
 class memCache;
 class memEntry {
@@ -121,9 +129,13 @@ class memCache {
 
    unsigned int block_size;
 
-   long word_cache;
-   Dyninst::Address word_cache_addr;
-   bool word_cache_valid;
+   //Page cache for synchronous reads, indexed by page address
+   typedef std::map<Dyninst::Address, char *> page_cache_t;
+   page_cache_t pages;
+   unsigned long page_hits;
+   unsigned long page_misses;
+   unsigned long page_reads;
+
    bool pending_async;
    bool have_writes;
    bool sync_handle;
@@ -134,6 +146,8 @@ class memCache {
    async_ret_t getExistingOperation(mcache_t::iterator i, memEntry *orig);   
    async_ret_t lookupAsync(memEntry *me, int_thread *op_thread);
    void updateReadCacheWithWrite(Address dest, char *src, unsigned long size);
+   bool fetchPages(Dyninst::Address start, Dyninst::Address end, int_thread *reading_thread);
+   void clearPages();
   public:
    memCache(int_process *p);
    ~memCache();
@@ -152,6 +166,10 @@ class memCache {
    void markToken(token_t tk);
    void condense();
 
+   //Drop cached pages overlapping a range that is about to change
+   void invalidate(Dyninst::Address addr, unsigned long size);
+   void getCounters(unsigned long &hits, unsigned long &misses, unsigned long &reads) const;
+
   private:
    async_ret_t readMemoryAsync(void *dest, Dyninst::Address src, unsigned long size, 
                                std::set<mem_response::ptr> &resps,
@@ -0,0 +1,125 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(NONSTOP_BP_H_)
+#define NONSTOP_BP_H_
+
+#include "common/h/dyntypes.h"
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+
+class int_process;
+class int_breakpoint;
+
+/**
+ * Non-stopping breakpoints (Breakpoint::setNonStopping) count their
+ * hits without stopping the process.
+ *
+ * Where the platform can displace the instruction at a site
+ * (int_process::plat_createNonStopStub), the site is overwritten with a
+ * jump to a stub.  The stub adds one to the site's counter, appends the
+ * site's index to a ring buffer, runs the displaced instruction and
+ * jumps back.  The counters and the ring share one area of the process's
+ * memory, which drain reads while the process runs
+ * (int_process::plat_readMemRunning), so a hit never stops anything.
+ * Stubs are mapped in blocks near the sites they serve, so that a short
+ * jump reaches them (int_process::plat_findFreeMemoryNear).
+ *
+ * Other sites get an ordinary trap.  The breakpoint handler counts its
+ * hits here and continues the process without a callback.
+ *
+ * The object lives in the mem_state, so forked children inherit it and
+ * exec discards it along with the memory it describes.
+ **/
+class nonstop_breakpoints
+{
+  public:
+   //Layout of the counter area: the number of hits ever logged, a
+   // counter per site and a ring of site indices
+   static const unsigned max_sites = 1024;
+   static const unsigned ring_entries = 4096;
+   static const unsigned head_offset = 0;
+   static const unsigned counters_offset = 8;
+   static const unsigned ring_offset = counters_offset + 8 * max_sites;
+   static const unsigned area_size = ring_offset + 4 * ring_entries;
+   //Room for one stub, and the most bytes a site may displace
+   static const unsigned max_stub_size = 128;
+   static const unsigned max_displaced = 32;
+   //Stubs per block, and how far from a site its stub may be: a rel32
+   // jump, less a margin
+   static const unsigned block_stubs = 512;
+   static const Dyninst::Address stub_reach = 0x7f000000;
+
+   nonstop_breakpoints();
+
+   //Install bp at addr with a jump.  Returns false, having changed
+   // nothing, if addr needs a trap instead.
+   bool addJump(int_process *proc, Dyninst::Address addr, int_breakpoint *bp);
+   //Remove bp from a jump at addr.  found is false if it has none there.
+   bool rmJump(int_process *proc, Dyninst::Address addr, int_breakpoint *bp, bool &found);
+   bool hasJump(Dyninst::Address addr, int_breakpoint *bp) const;
+   //A trap is about to be written at addr.  Any jump whose displaced
+   // bytes include addr is removed, and its breakpoints become traps.
+   bool clearJumpsAt(int_process *proc, Dyninst::Address addr);
+   bool removeAllJumps(int_process *proc);
+
+   void noteTrapHit(Dyninst::Address addr);
+   bool drain(int_process *proc, std::map<Dyninst::Address, unsigned long> &counts,
+              std::vector<Dyninst::Address> *log);
+
+  private:
+   struct site_t {
+      unsigned index;
+      unsigned displaced;
+      unsigned char orig[max_displaced];
+      std::set<int_breakpoint *> bps;
+   };
+   std::map<Dyninst::Address, site_t> sites;
+   std::vector<Dyninst::Address> site_addrs;   //By index, never reused
+   std::set<Dyninst::Address> trap_only;
+   Dyninst::Address area;
+   struct stub_block_t {
+      Dyninst::Address base;
+      unsigned used;
+   };
+   std::vector<stub_block_t> stub_blocks;
+   unsigned long ring_tail;
+   std::map<Dyninst::Address, unsigned long> trap_counts;
+   std::deque<Dyninst::Address> trap_log;
+
+   bool allocate(int_process *proc);
+   //A free stub slot within reach of addr, in a new block if need be
+   stub_block_t *findStubBlock(int_process *proc, Dyninst::Address addr);
+   bool restoreSite(int_process *proc, Dyninst::Address addr, const site_t &site);
+};
+
+#endif
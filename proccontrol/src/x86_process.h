@@ -47,6 +47,11 @@ class x86_process : virtual public int_process
   virtual void plat_breakpointBytes(unsigned char *buffer);
   virtual bool plat_breakpointAdvancesPC() const;
   virtual Address plat_findFreeMemory(size_t) { return 0; }
+  virtual bool plat_createNonStopStub(Dyninst::Address addr, const unsigned char *orig,
+                                      unsigned orig_size, Dyninst::Address stub,
+                                      Dyninst::Address area, unsigned index,
+                                      std::vector<unsigned char> &stub_code,
+                                      std::vector<unsigned char> &jump_code);
 };
 
 class x86_thread : virtual public int_thread
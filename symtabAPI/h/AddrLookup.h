@@ -52,9 +52,25 @@ class SYMTAB_EXPORT AddressLookup : public AnnotatableSparse
  private:
    AddressTranslate *translator;
    AddressLookup(AddressTranslate *trans);
-   static dyn_hash_map<std::string, std::vector<Symbol *> > syms;
-   int getSymsVector(std::string str);
-   std::vector<Symbol *> *getSymsVector(LoadedLib *lib);
+
+   // A library's symbols sorted by offset, one per start offset.  end is
+   // start + size, or the next symbol's start for unsized symbols;
+   // parent is the nearest earlier entry whose range contains start.
+   struct SymbolRange {
+      Offset start;
+      Offset end;
+      int parent;
+      Symbol *sym;
+   };
+   typedef std::vector<SymbolRange> SymbolIndex;
+   static dyn_hash_map<std::string, SymbolIndex> sym_index;
+   const SymbolIndex *getSymbolIndex(LoadedLib *lib);
+   bool getLibsAtAddresses(const std::vector<Address> &addrs,
+                           const std::vector<unsigned> &order,
+                           std::vector<LoadedLib *> &libs);
+   static Symbol *lookupSymbol(const SymbolIndex &index,
+                               SymbolIndex::const_iterator pos,
+                               Offset off, bool close);
 
    std::map<Symtab *, LoadedLib *> sym_to_ll;
    std::map<LoadedLib *, Symtab *> ll_to_sym;
@@ -71,6 +87,13 @@ class SYMTAB_EXPORT AddressLookup : public AnnotatableSparse
    bool getAddress(Symtab *tab, Offset off, Address &addr);
 
    bool getSymbol(Address addr, Symbol* &sym, Symtab* &tab, bool close = false);
+   bool getSymbols(const std::vector<Address> &addrs,
+                   std::vector<Symbol *> &syms,
+                   std::vector<Symtab *> &tabs,
+                   bool close = false);
+   bool symbolize(const std::vector<Address> &addrs,
+                  std::vector<AddressInfo> &infos,
+                  std::vector<Symtab *> &tabs);
    bool getOffset(Address addr, Symtab* &tab, Offset &off);
    
    bool getAllSymtabs(std::vector<Symtab *> &tabs);
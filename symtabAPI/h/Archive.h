@@ -108,19 +108,60 @@ class SYMTAB_EXPORT Archive : public AnnotatableSparse {
        */
       bool parseSymbolTable();      
 
+      /**
+       * This method is architecture specific
+       *
+       * Post-condition:
+       *        sets member to the member whose header is at offset,
+       *        recording it if it has not been seen before
+       *        sets serr and errMsg if there is no such member
+       */
+      bool findMember(ArchiveMember *&member, Offset offset);
+
+      /**
+       * This method is architecture specific
+       *
+       * Post-condition:
+       *        records every member of the archive by name
+       *        sets serr and errMsg if there is an error
+       */
+      bool parseMemberList();
+
+      /**
+       * This method is architecture specific
+       *
+       * Releases the member images created by parseMember
+       */
+      void unmapMembers();
+
       MappedFile *mf;
 
       //architecture specific data - 
-      //For ELF the elf pointer for the archive
+      //For ELF the mapped archive
       void *basePtr;
 
       dyn_hash_map<std::string, ArchiveMember *> membersByName;
       dyn_hash_map<Offset, ArchiveMember *> membersByOffset;
-      std::multimap<std::string, ArchiveMember *> membersBySymbol;
+      // Symbols in the archive's symbol table, with the offsets of
+      // their members' headers
+      std::multimap<std::string, Offset> membersBySymbol;
 
       // The symbol table is lazily parsed
       bool symbolTableParsed;
 
+      // Members are only found through the symbol table until a lookup
+      // by name or a list of all members needs the rest
+      bool membersListed;
+
+      // Locations of the first member, the symbol table and the long
+      // member name table in the archive
+      Offset firstMember;
+      Offset symbolTable;
+      Offset longNames;
+
+      // Separately mapped images of the parsed members
+      std::vector<std::pair<void *, size_t> > memberImages;
+
       // A vector of all Archives. Used to avoid duplicating
       // an Archive that already exists.
       static std::vector<Archive *> allArchives;
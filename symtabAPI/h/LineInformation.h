@@ -37,20 +37,39 @@
 #include "Annotatable.h"
 #include "Module.h"
 
+#include <deque>
+#include <vector>
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+
 #define NEW_GETSOURCELINES_INTERFACE
 
 namespace Dyninst{
 namespace SymtabAPI{
 
-class SYMTAB_EXPORT LineInformation : 
-                        private RangeLookupTypes< Statement >::type
+/*
+ * Statements are appended as they are parsed and indexed on the first
+ * query: a flat array sorted by start address holds every statement
+ * that does not overlap an earlier one, and the (usually few) that do
+ * go in a side table searched with a running maximum of end addresses.
+ * Adding lines after a query drops the index, which is rebuilt on the
+ * next query, so every iterator and range handed out before the add is
+ * invalid after it; the Statement pointers themselves stay valid.
+ * Callers must not hold iterators across addLine or addLineInfo (or
+ * Module::parseLineInformation, which calls them).  A statement with
+ * the same address range as an earlier one is left out of the index
+ * when it is built; addLine no longer detects this and returns true.
+ */
+class SYMTAB_EXPORT LineInformation
 {
 public:
+    // The multi_index types LineInformation used to derive from, kept for
+    // source compatibility; nothing here uses them
     typedef RangeLookupTypes< Statement> traits;
     typedef RangeLookupTypes< Statement >::type impl_t;
-    typedef impl_t::index<Statement::addr_range>::type::const_iterator const_iterator;
-    typedef impl_t::index<Statement::line_info>::type::const_iterator const_line_info_iterator;
-    typedef traits::value_type Statement_t;
+    typedef Statement::Ptr Statement_t;
+    typedef std::vector<Statement_t>::const_iterator const_iterator;
+    typedef std::vector<Statement_t>::const_iterator const_line_info_iterator;
       LineInformation();
 
       /* You MAY freely deallocate the lineSource strings you pass in. */
@@ -100,9 +119,27 @@ public:
 
     void setStrings(StringTablePtr strings_);
 
-protected:
-    mutable int wasted_compares;
-    mutable int num_queries;
+private:
+    void freeze() const;
+    void thaw();
+    // Indices into by_addr_ of the statements containing addr, in
+    // address order
+    void findAll(Offset addr, std::vector<unsigned> &found) const;
+
+    // Owns the statements, duplicates included; a deque keeps handed-out
+    // pointers stable
+    std::deque<Statement> statements_;
+
+    // Built by freeze()
+    mutable boost::atomic<bool> frozen_;
+    mutable boost::mutex freeze_lock_;
+    mutable std::vector<Statement_t> by_addr_;
+    mutable std::vector<Statement_t> by_line_;
+    mutable std::vector<Offset> flat_starts_;
+    mutable std::vector<unsigned> flat_;
+    mutable std::vector<Offset> side_starts_;
+    mutable std::vector<Offset> side_max_end_;
+    mutable std::vector<unsigned> side_;
 };
 
 
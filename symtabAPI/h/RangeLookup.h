@@ -95,6 +95,8 @@ namespace Dyninst {
             os << std::hex << "[" << ar.first << ", " << ar.second << ")";
             return os;
         }
+        // LineInformation no longer derives from this index; it is kept
+        // for code built against the old interface
         template <typename Value>
         struct RangeLookupTypes
         {
@@ -271,7 +271,38 @@ class SYMTAB_EXPORT Symbol : public Serializable,
 
    Aggregate *   aggregate_; // Pointer to Function or Variable container, if appropriate.
 
-   std::string mangledName_;
+   // Names of up to 15 characters are kept inline, as std::string keeps
+   // short names; longer ones are counted handles into the shared
+   // NamePool (src/NamePool.h), which frees a name once no Symbol holds
+   // it.  A name has one representation, so equal names compare equal.
+   class PoolName {
+    public:
+      PoolName();
+      PoolName(const PoolName &o);
+      PoolName &operator=(const PoolName &o);
+      ~PoolName();
+      void set(const std::string &name);
+      void clear();
+      void swap(PoolName &o);
+      bool empty() const { return !buf_[0] && !pooled(); }
+      std::string str() const;
+      bool operator==(const PoolName &o) const;
+    private:
+      // Inline: the NUL-terminated name, then zeros.  Pooled: the handle
+      // in the first bytes and 1 in the last.
+      char buf_[16];
+      bool pooled() const { return buf_[sizeof(buf_) - 1] != 0; }
+      unsigned int handle() const;
+   };
+   PoolName mangledName_;
+
+   // Demangled names are computed on first request and cached; see
+   // getPrettyName.  Guarded by a lock striped over Symbol addresses.
+   mutable PoolName prettyName_;
+   mutable PoolName typedName_;
+   mutable bool prettyNameValid_;
+   mutable bool typedNameValid_;
+   void invalidateDemangledNames();
 
    SymbolTag     tag_;
    int index_;
@@ -47,6 +47,7 @@
 #include "pfq-rwlock.h"
 
 #include "boost/shared_ptr.hpp"
+#include <boost/thread/mutex.hpp>
 #include "boost/multi_index_container.hpp"
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/mem_fun.hpp>
@@ -92,6 +93,43 @@ typedef IBSTree< ModRange > ModRangeLookup;
 typedef IBSTree<FuncRange> FuncRangeLookup;
 typedef Dyninst::ProcessReader MemRegReader;
 
+// One result of Symtab::symbolize; any member may be NULL
+struct AddressInfo {
+   Offset offset;
+   Module *module;
+   Function *function;          // as getContainingFunction
+   FunctionBase *inlined;       // as getContainingInlinedFunction
+   Statement::ConstPtr line;    // first statement covering offset
+};
+
+// Approximate heap memory held by one Symtab, in bytes, as reported by
+// Symtab::getMemoryUsage.  Object sizes count the objects themselves but
+// not strings or other data they share; index sizes count the container
+// nodes and hash buckets, not the objects indexed.
+struct SymtabMemoryUsage {
+   // Objects
+   size_t symbols;
+   size_t functions;
+   size_t variables;
+   size_t modules;
+   size_t regions;
+
+   // Indices
+   size_t symbolsById;          // every defined and undefined symbol
+   size_t symbolsByOffset;
+   size_t symbolsByMangledName;
+   size_t symbolsByPrettyName;
+   size_t symbolsByTypedName;
+   size_t funcsByOffset;
+   size_t varsByOffset;
+   size_t regionsByEntryAddr;
+   size_t moduleIndices;
+   size_t addressRanges;        // function and module range lookup trees
+
+   size_t objects() const;
+   size_t indices() const;
+};
+
 class SYMTAB_EXPORT Symtab : public LookupInterface,
                public Serializable,
                public AnnotatableSparse
@@ -125,10 +163,30 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
       NotDefensive,
       Defensive} def_t; 
 
+   // Symbol lookup indices.  Those named when a file is opened are built
+   // then; the others are built by the first lookup that needs them.
+   // Each costs a container node per symbol; see getMemoryUsage.
+   enum SymbolIndex {
+      NoSymbolIndices = 0,
+      IndexByOffset = 1,        // findSymbolByOffset
+      IndexByMangled = 2,       // findSymbol by mangledName
+      IndexByName = 4,          // findSymbol by prettyName
+      IndexByType = 8,          // findSymbol by typedName
+      AllSymbolIndices = IndexByOffset | IndexByMangled | IndexByName | IndexByType,
+      // Name indices are left to the first lookup by name
+      DefaultSymbolIndices = IndexByOffset
+   };
+
    static bool openFile(Symtab *&obj, std::string filename, 
                                       def_t defensive_binary = NotDefensive);
    static bool openFile(Symtab *&obj, void *mem_image, size_t size, 
                                       std::string name, def_t defensive_binary = NotDefensive);
+   // As above, building the SymbolIndex bits in `indices' at open
+   static bool openFile(Symtab *&obj, std::string filename,
+                                      def_t defensive_binary, unsigned indices);
+   static bool openFile(Symtab *&obj, void *mem_image, size_t size,
+                                      std::string name, def_t defensive_binary,
+                                      unsigned indices);
    static Symtab *findOpenSymtab(std::string filename);
    static bool closeSymtab(Symtab *);
 
@@ -161,6 +219,10 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
 
    std::vector<Symbol *> findSymbolByOffset(Offset);
 
+   // Builds the given SymbolIndex indices now rather than on first use
+   void buildSymbolIndices(unsigned indices);
+   void getMemoryUsage(SymtabMemoryUsage &usage);
+
    // Return all undefined symbols in the binary. Currently used for finding
    // the .o's in a static archive that have definitions of these symbols
    bool getAllUndefinedSymbols(std::vector<Symbol *> &ret);
@@ -260,6 +322,11 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    void setTruncateLinePaths(bool value);
    bool getTruncateLinePaths();
    void forceFullLineInfoParse();
+
+   // Resolves the module, function, inlined function and source line of
+   // every offset in one pass; infos[i] describes offsets[i]
+   bool symbolize(const std::vector<Offset> &offsets,
+                  std::vector<AddressInfo> &infos);
    
    /***** Type Information *****/
    virtual bool findType(Type *&type, std::string name);
@@ -275,6 +342,9 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    static std::vector<Type *> *getAllbuiltInTypes();
 
    void parseTypesNow();
+   // Types and variables of one module, parsing no others unless this
+   // file's format requires it
+   void parseTypesNow(Module *mod);
 
    /***** Local Variable Information *****/
    bool findLocalVariable(std::vector<localVar *>&vars, std::string name);
@@ -530,16 +600,51 @@ class SYMTAB_EXPORT Symtab : public LookupInterface,
    
    typedef 
    boost::multi_index_container<Symbol::Ptr, indexed_by <
-   ordered_unique< tag<id>, const_mem_fun < Symbol::Ptr, Symbol*, &Symbol::Ptr::get> >,
-   ordered_non_unique< tag<offset>, const_mem_fun < Symbol, Offset, &Symbol::getOffset > >,
-   hashed_non_unique< tag<mangled>, const_mem_fun < Symbol, std::string, &Symbol::getMangledName > >,
-   hashed_non_unique< tag<pretty>, const_mem_fun < Symbol, std::string, &Symbol::getPrettyName > >,
-   hashed_non_unique< tag<typed>, const_mem_fun < Symbol, std::string, &Symbol::getTypedName > >
+   ordered_unique< tag<id>, const_mem_fun < Symbol::Ptr, Symbol*, &Symbol::Ptr::get> >
    >
    > indexed_symbols;
    
    indexed_symbols everyDefinedSymbol;
    indexed_symbols undefDynSyms;
+
+   // Lookup indices, one container per SymbolIndex.  Each is built by
+   // buildSymbolIndices, when the file is opened or by the first lookup
+   // that needs it, and is kept up to date from then on.
+   typedef 
+   boost::multi_index_container<Symbol::Ptr, indexed_by <
+   ordered_non_unique< tag<offset>, const_mem_fun < Symbol, Offset, &Symbol::getOffset > >
+   >
+   > offset_indexed_symbols;
+   typedef 
+   boost::multi_index_container<Symbol::Ptr, indexed_by <
+   hashed_non_unique< tag<mangled>, const_mem_fun < Symbol, std::string, &Symbol::getMangledName > >
+   >
+   > mangled_indexed_symbols;
+   typedef 
+   boost::multi_index_container<Symbol::Ptr, indexed_by <
+   hashed_non_unique< tag<pretty>, const_mem_fun < Symbol, std::string, &Symbol::getPrettyName > >
+   >
+   > pretty_indexed_symbols;
+   typedef 
+   boost::multi_index_container<Symbol::Ptr, indexed_by <
+   hashed_non_unique< tag<typed>, const_mem_fun < Symbol, std::string, &Symbol::getTypedName > >
+   >
+   > typed_indexed_symbols;
+
+   offset_indexed_symbols definedSymsByOffset;
+   mangled_indexed_symbols definedSymsByMangled;
+   mangled_indexed_symbols undefDynSymsByMangled;
+   pretty_indexed_symbols definedSymsByPretty;
+   pretty_indexed_symbols undefDynSymsByPretty;
+   typed_indexed_symbols definedSymsByTyped;
+   typed_indexed_symbols undefDynSymsByTyped;
+
+   unsigned symbol_indices_;     // SymbolIndex bits of the indices built
+   boost::mutex symbol_indices_lock_;
+   void buildIndices(unsigned indices);
+   void indexSymbol(Symbol *sym, bool undefined);
+   void unindexSymbol(Symbol *sym, bool undefined);
+   void clearSymbolIndices();
    
    // We also need per-Aggregate indices
    bool sorted_everyFunction;
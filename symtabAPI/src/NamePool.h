@@ -0,0 +1,85 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ *
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ *
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+#ifndef _NAME_POOL_H_
+#define _NAME_POOL_H_
+
+#include <stddef.h>
+#include <string>
+
+namespace Dyninst {
+namespace SymtabAPI {
+
+/*
+ * Process-wide pool of interned, immutable name strings.
+ *
+ * Symbol names longer than a Symbol keeps inline are stored here once
+ * and referred to by 32-bit handles, so that a name shared by several
+ * Symbols (.symtab and .dynsym copies, the same library opened twice,
+ * identical demangled names) costs a single copy.  A name held once
+ * costs its characters, a 12-byte header, and about 16 bytes of index,
+ * no more than a std::string's heap block.  Handle 0 is the empty
+ * string.
+ *
+ * The pool is shared rather than kept per Symtab because Symbols are
+ * created without a Symtab, copied, and moved between Symtabs, and a
+ * per-Symtab pool would cost every Symbol a pointer to find its names
+ * by.  Instead each name is reference counted: intern() and acquire()
+ * take a reference, release() drops one, and a name is forgotten when
+ * its last reference goes.  Strings are packed into chunks, and a chunk
+ * is freed once every string in it has been; a handle stays valid while
+ * its holder keeps a reference, and may name another string after.
+ *
+ * All calls may be made concurrently; get() and str() take no lock.
+ */
+class NamePool {
+ public:
+    typedef unsigned int handle_t;
+    static const handle_t empty = 0;
+
+    // Return a referenced handle to the string
+    static handle_t intern(const char *str, size_t len);
+    static handle_t intern(const std::string &s) { return intern(s.data(), s.size()); }
+    static void acquire(handle_t h);
+    static void release(handle_t h);
+
+    // NUL-terminated
+    static const char *get(handle_t h);
+    static size_t length(handle_t h);
+    static std::string str(handle_t h) { return std::string(get(h), length(h)); }
+
+    // Live strings and bytes of chunk storage held by the pool
+    static size_t count();
+    static size_t bytes();
+};
+
+}
+}
+
+#endif
@@ -72,6 +72,9 @@ namespace DwarfDyninst {
 }
 
 namespace SymtabAPI{
+
+struct DwarfUnitIndex;
+
 /*
  * The standard symbol table in an elf file is the .symtab section. This section does
  * not have information to find the module to which a global symbol belongs, so we must
@@ -285,6 +288,9 @@ public:
   void parseFileLineInfo();
   
   void parseTypeInfo();
+  // Types and variables of one module only; false if this file's
+  // debug information can only be parsed as a whole
+  bool parseTypeInfo(Module *mod);
 
   bool needs_function_binding() const { return (plt_addr_ > 0); } 
   bool get_func_binding_table(std::vector<relocationEntry> &fbt) const;
@@ -596,6 +602,9 @@ private:
   bool DbgSectionMapSorted;
   std::vector<DbgAddrConversion_t> DebugSectionMap;
 
+  // DWARF units by module, for parsing types one module at a time
+  DwarfUnitIndex *dwarf_units_;
+
  public:  
   std::set<std::string> prereq_libs;
   std::vector<std::pair<long, long> > new_dynamic_entries;
@@ -8,6 +8,7 @@
 #include "elf.h"
 #include "libelf.h"
 #include "elfutils/libdw.h"
+#include <map>
 #include <stack>
 #include <vector>
 #include <string>
@@ -17,6 +18,8 @@
 #include "Type.h"
 #include "Object.h"
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+#include "tbb/concurrent_hash_map.h"
 #include <Collections.h>
 
 namespace Dyninst {
@@ -198,6 +201,49 @@ struct ContextGuard {
     ~ContextGuard() { c.pop(); }
 };
 
+/*
+ * The compilation and type units of one debug file, grouped by the
+ * Module they map to, so that a module's types, variables and inlined
+ * functions can be parsed when it is first asked about instead of with
+ * every other module.  Type units are indexed by signature as well: a
+ * DW_FORM_ref_sig8 into another module's type unit is resolved by
+ * parsing just that module.
+ */
+struct DwarfUnitIndex {
+    struct Unit {
+        Dwarf_Off offset;   // of the unit DIE within its section
+        bool is_info;       // .debug_info rather than .debug_types
+        uint64_t signature; // of a type unit
+    };
+    struct ModuleUnits {
+        ModuleUnits() : has_type_units(false), parsed(false) {}
+        std::vector<Unit> units;
+        bool has_type_units;
+        bool parsed;
+    };
+    struct Sig8Type {
+        Module *mod;
+        typeId_t id;
+    };
+
+    typedef tbb::concurrent_hash_map<Dwarf_Off, typeId_t> TypeIds;
+
+    DwarfUnitIndex() : built(false), fixUnknownMod(NULL) {}
+
+    bool built;
+    Module *fixUnknownMod;                 // module of the first unit
+    std::vector<Module *> order;           // modules by their first unit
+    std::map<Module *, ModuleUnits> modules;
+    dyn_hash_map<uint64_t, Sig8Type> sig8_types;
+    TypeIds info_type_ids;                 // .debug_info offset -> id
+    TypeIds types_type_ids;                // .debug_types offset -> id
+
+    // Held while the index is built, while a module is claimed for
+    // parsing and while parseModuleUnits parses one; not held by the
+    // parallel workers of DwarfWalker::parse
+    boost::recursive_mutex lock;
+};
+
 class DwarfWalker : public DwarfParseActions {
 
 public:
@@ -206,7 +252,7 @@ public:
 
     } Error;
 
-    DwarfWalker(Symtab *symtab, Dwarf* dbg);
+    DwarfWalker(Symtab *symtab, Dwarf* dbg, DwarfUnitIndex *units = NULL);
 
     DwarfWalker(const DwarfWalker& o) :
             DwarfParseActions(o),
@@ -225,17 +271,25 @@ public:
             typeoffset(o.typeoffset),
             next_cu_header(o.next_cu_header),
             compile_offset(o.compile_offset),
-            info_type_ids_(o.info_type_ids_),
-            types_type_ids_(o.types_type_ids_),
-            sig8_type_ids_(o.sig8_type_ids_) {}
+            unit_index_(o.unit_index_),
+            unit_is_info_(o.unit_is_info_) {}
 
     virtual ~DwarfWalker();
 
+    // Parses every module not yet parsed
     bool parse();
 
+    // Parses the units of one module, and of any module holding a type
+    // unit that they reference; requires a DwarfUnitIndex
+    bool parseModuleUnits(Module *m);
+
     // Takes current debug state as represented by dbg_;
     bool parseModule(Dwarf_Die is_info, Module *&fixUnknownMod);
 
+    // Sets mod() to the Module that a compilation or type unit's
+    // contents belong to; false if the DIE is not a unit
+    bool findModuleForUnit(Dwarf_Die moduleDIE);
+
     // Non-recursive version of parse
     // A Context must be provided as an _input_ to this function,
     // whereas parse creates a context.
@@ -244,6 +298,8 @@ public:
 private:
     Dwarf_Die current_cu_die;
 
+    bool findModuleName(Dwarf_Die moduleDIE, std::string &moduleName);
+
     enum inline_t {
         NormalFunc,
         InlinedFunc
@@ -404,15 +460,17 @@ private:
 
     // Type IDs are just int, but Dwarf_Off is 64-bit and may be relative to
     // either .debug_info or .debug_types.
-    dyn_hash_map<Dwarf_Off, typeId_t> info_type_ids_; // .debug_info offset -> id
-    dyn_hash_map<Dwarf_Off, typeId_t> types_type_ids_; // .debug_types offset -> id
     typeId_t get_type_id(Dwarf_Off offset, bool is_info);
     typeId_t type_id(); // get_type_id() for the current entry
 
-    // Map to connect DW_FORM_ref_sig8 to type IDs.
-    dyn_hash_map<uint64_t, typeId_t> sig8_type_ids_;
-    bool parseModuleSig8(bool is_info);
-    void findAllSig8Types();
+    // Units by module and DW_FORM_ref_sig8 targets; shared by the
+    // walkers of every unit of a file
+    DwarfUnitIndex *unit_index_;
+    // Whether the unit being parsed is in .debug_info or .debug_types
+    bool unit_is_info_;
+    void buildUnitIndex();
+    bool parseUnits(Dwarf *dbg, Module *m);
+    bool fixupModuleTypes(Module *m);
     bool findSig8Type(Dwarf_Sig8 * signature, Type *&type);
 
 protected:
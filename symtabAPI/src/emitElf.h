@@ -266,10 +266,18 @@ namespace Dyninst {
                                       unsigned &verdefSecSize, unsigned &dynSymbolNamesLength,
                                       std::vector<std::string> &dynStrs);
 
-            void createHashSection(Elf_Word *&hashsecData, unsigned &hashsecSize, std::vector<Symbol *> &dynSymbols);
+            void markOriginalHashEntries(std::vector<bool> &hashed);
+
+            void createHashSection(Elf_Word *&hashsecData, unsigned &hashsecSize, std::vector<Symbol *> &dynSymbols,
+                                   const std::vector<bool> &origHashed);
+
+            bool createGnuHashSection(char *&gnuHashData, unsigned &gnuHashSize, std::vector<Elf_Sym *> &dynsymbols,
+                                      std::vector<Symbol *> &dynSymbols, const std::vector<bool> &origHashed,
+                                      dyn_hash_map<std::string, unsigned long> &dynSymNameMapping);
 
             void createDynamicSection(void *dynData, unsigned size, Elf_Dyn *&dynsecData, unsigned &dynsecSize,
-                                      unsigned &dynSymbolNamesLength, std::vector<std::string> &dynStrs);
+                                      unsigned &dynSymbolNamesLength, std::vector<std::string> &dynStrs,
+                                      bool keepGnuHash);
 
             void addDTNeeded(std::string s);
 